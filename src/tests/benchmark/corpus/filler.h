@@ -0,0 +1,181 @@
+#pragma once
+
+#include "benchmark/corpus/generator.h"
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace corpus {
+
+// Fills a structure with random values. Filler is one more packer for the
+// jserializeMethod() declared by J_SERIALIZE_BEGIN ... J_SERIALIZE_END, the
+// same way as json::Reader and json::Writer are: fields, their types and
+// optionality are taken from the J_SERIALIZE declaration of the structure,
+// a new structure in the corpus does not need a hand-written fill function.
+// The size of the JSON document is estimated while filling, lists stop
+// growing once the budget is spent
+class Filler
+{
+public:
+    struct Params
+    {
+        qint64 budget    = {std::numeric_limits<qint64>::max()}; // Bytes
+        int    maxDepth  = {1};   // Nesting depth of lists
+        int    fanout    = {0};   // Items per list, 0 - until the budget is spent
+        int    maxString = {24};  // Maximum length of string fields
+        double optional  = {0.5}; // Probability that an optional scalar field is set
+    };
+
+    Filler(Generator& gen, const Params& params)
+        : _gen(gen), _params(params), _remaining(params.budget)
+    {}
+
+    template<typename T>
+    static T make(Generator& gen, const Params& params)
+    {
+        T obj;
+        Filler filler {gen, params};
+        filler & obj;
+        return obj;
+    }
+
+    //--------------------------- Packer interface --------------------------
+
+    Filler& startObject() {spend(2); return *this;}
+    Filler& endObject() {return *this;}
+
+    Filler& member(const char* name, bool optional = false)
+    {
+        _skip = optional && !_gen.chance(_params.optional);
+        if (!_skip)
+            spend(qint64(std::strlen(name)) + 4);
+        return *this;
+    }
+
+    Filler& operator& (QString& s)
+    {
+        if (skip())
+            return *this;
+
+        s = _gen.string(_params.maxString);
+        spend(s.toUtf8().size() + 2);
+        return *this;
+    }
+
+    // Raw JSON field, filled with a number
+    Filler& operator& (QByteArray& ba)
+    {
+        if (skip())
+            return *this;
+
+        ba = QByteArray::number(_gen.range(0, 1000000));
+        spend(ba.size());
+        return *this;
+    }
+
+    template<typename T>
+    Filler& operator& (QList<T>& list)
+    {
+        return fillList(list);
+    }
+
+    template<typename T>
+    Filler& operator& (QVector<T>& list)
+    {
+        return fillList(list);
+    }
+
+    // Scalars and nested structures
+    template<typename T>
+    Filler& operator& (T& value)
+    {
+        if constexpr (std::is_same_v<T, bool>)
+        {
+            if (skip())
+                return *this;
+
+            value = _gen.chance(0.5);
+            spend(5);
+        }
+        else if constexpr (std::is_floating_point_v<T>)
+        {
+            if (skip())
+                return *this;
+
+            value = T(_gen.real() * 1e6 - 5e5);
+            spend(QByteArray::number(double(value), 'g', 17).size());
+        }
+        else if constexpr (std::is_integral_v<T>)
+        {
+            if (skip())
+                return *this;
+
+            // Up to 10^6 for 32-bit and smaller types (ids, counters),
+            // up to 2*10^12 for 64-bit types (timestamps in milliseconds)
+            const qint64 max = (sizeof(T) < 8)
+                ? std::min<qint64>(std::numeric_limits<T>::max(), 1000000)
+                : 2000000000000ll;
+            const qint64 min = std::is_signed_v<T> ? -max : 0;
+
+            value = T(_gen.range(min, max));
+            spend(QByteArray::number(qint64(value)).size());
+        }
+        else
+        {
+            // Nested structures are always filled, the budget limits them
+            _skip = false;
+            T::jserializeMethod(&value, *this);
+        }
+        return *this;
+    }
+
+private:
+    bool skip()
+    {
+        bool result = _skip;
+        _skip = false;
+        return result;
+    }
+
+    void spend(qint64 bytes)
+    {
+        _remaining -= bytes;
+    }
+
+    template<typename ListT>
+    Filler& fillList(ListT& list)
+    {
+        // Lists are always present, they are empty below the maximum depth
+        _skip = false;
+        list.clear();
+        spend(2);
+        if (_depth >= _params.maxDepth)
+            return *this;
+
+        ++_depth;
+        for (int i = 0; (_params.fanout == 0 || i < _params.fanout) && _remaining > 0; ++i)
+        {
+            list.append(typename ListT::value_type());
+            *this & list.last();
+            spend(1);
+        }
+        --_depth;
+        return *this;
+    }
+
+private:
+    Generator& _gen;
+    Params _params;
+    qint64 _remaining;
+    int    _depth = {0};
+    bool   _skip  = {false};
+};
+
+} // namespace corpus
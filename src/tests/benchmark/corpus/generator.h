@@ -0,0 +1,122 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+namespace corpus {
+
+// Deterministic source of random values. The distributions are computed
+// by hand (not with std::uniform_*_distribution) so that the same seed
+// gives the same corpus with any standard library
+class Generator
+{
+public:
+    explicit Generator(quint64 seed) : _state(seed ? seed : 0x9E3779B97F4A7C15ull)
+    {}
+
+    // xorshift64*
+    quint64 next()
+    {
+        _state ^= _state >> 12;
+        _state ^= _state << 25;
+        _state ^= _state >> 27;
+        return _state * 0x2545F4914F6CDD1Dull;
+    }
+
+    // Value in range [min, max]
+    qint64 range(qint64 min, qint64 max)
+    {
+        return min + qint64(next() % quint64(max - min + 1));
+    }
+
+    // Value in range [0, 1)
+    double real()
+    {
+        return double(next() >> 11) / double(1ull << 53);
+    }
+
+    bool chance(double probability)
+    {
+        return real() < probability;
+    }
+
+    // Mostly ASCII string, sometimes with cyrillic and escaped chars
+    QString string(int maxLength)
+    {
+        static const char* ascii = "abcdefghijklmnopqrstuvwxyz ABCDEFGHIJKLMNOPQRSTUVWXYZ 0123456789";
+        static const QString cyrillic = QString::fromUtf8("абвгдежзийклмнопрстуфхцчшщэюя");
+        static const QString escaped = QString::fromUtf8("\"\\/\n\t");
+
+        int length = int(range(0, maxLength));
+        QString s;
+        s.reserve(length);
+        for (int i = 0; i < length; ++i)
+        {
+            quint64 r = next() % 100;
+            if (r < 90)
+                s += QChar(ascii[next() % 64]);
+            else if (r < 98)
+                s += cyrillic[int(next() % quint64(cyrillic.size()))];
+            else
+                s += escaped[int(next() % quint64(escaped.size()))];
+        }
+        return s;
+    }
+
+private:
+    quint64 _state;
+};
+
+//----------------------- Near-valid documents ------------------------------
+
+// Cuts the document at a random position
+inline QByteArray truncate(const QByteArray& json, Generator& gen)
+{
+    if (json.size() < 2)
+        return {};
+
+    return json.left(int(gen.range(1, json.size() - 1)));
+}
+
+// Removes the last closing bracket of the document
+inline QByteArray unbalance(const QByteArray& json)
+{
+    int index = json.lastIndexOf('}');
+    if (index < 0)
+        return json;
+
+    QByteArray result = json;
+    result.remove(index, 1);
+    return result;
+}
+
+// Removes a random occurrence of the "key":value pair (value is a number),
+// for a mandatory key the document becomes invalid
+inline QByteArray dropKey(const QByteArray& json, const QByteArray& key, Generator& gen)
+{
+    const QByteArray pattern = '"' + key + "\":";
+
+    int count = json.count(pattern);
+    if (count == 0)
+        return json;
+
+    int from = 0;
+    for (qint64 n = gen.range(0, count - 1); n >= 0; --n)
+        from = json.indexOf(pattern, from) + ((n > 0) ? pattern.size() : 0);
+
+    int to = from + pattern.size();
+    while (to < json.size() && json[to] != ',' && json[to] != '}')
+        ++to;
+
+    // Remove the comma that follows the pair, or the one before it
+    if (to < json.size() && json[to] == ',')
+        ++to;
+    else if (from > 0 && json[from - 1] == ',')
+        --from;
+
+    QByteArray result = json;
+    result.remove(from, to - from);
+    return result;
+}
+
+} // namespace corpus
@@ -0,0 +1,382 @@
+#include "shared/logger/logger.h"
+#include "pproto/serialize/json.h"
+#include "benchmark/corpus/generator.h"
+#include "benchmark/corpus/filler.h"
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+#include "catch2/internal/catch_clara.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace pproto {
+namespace data {
+
+struct Rec
+{
+    qint64  time  = {0};
+    qint32  id    = {0};
+    double  value = {0};
+    QString tag;
+    QString note;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( time  )
+        J_SERIALIZE_ITEM( id    )
+        J_SERIALIZE_ITEM( value )
+        J_SERIALIZE_ITEM( tag   )
+        J_SERIALIZE_OPT ( note  )
+    J_SERIALIZE_END
+};
+
+struct RecList
+{
+    qint32     version = {1};
+    QList<Rec> list;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( version )
+        J_SERIALIZE_ITEM( list    )
+    J_SERIALIZE_END
+};
+
+struct Node
+{
+    qint32      id = {0};
+    QString     name;
+    QList<Node> children;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( id       )
+        J_SERIALIZE_OPT ( name     )
+        J_SERIALIZE_OPT ( children )
+    J_SERIALIZE_END
+};
+
+} // namespace data
+} // namespace pproto
+
+namespace {
+
+quint64     corpusSeed      = {20240501};
+qint64      corpusMaxSize   = {10000000};
+int         corpusDepth     = {256};
+int         corpusTreeDepth = {6};
+std::string corpusOut;
+
+using pproto::data::Rec;
+using pproto::data::RecList;
+using pproto::data::Node;
+
+//---------------------------------- Corpus ---------------------------------
+
+// Flat records, the list grows up to the target size
+RecList makeRecList(qint64 targetSize, corpus::Generator& gen)
+{
+    corpus::Filler::Params params;
+    params.budget   = targetSize;
+    params.maxDepth = 1;
+    params.optional = 0.3;
+    return corpus::Filler::make<RecList>(gen, params);
+}
+
+// Tree of the given depth. The fanout is the smallest one at which the full
+// tree over all depth + 1 levels reaches the target size, the filler stops
+// at the target size, so the last subtrees are cut rather than the document
+// overshoots the size of the bucket
+Node makeTree(qint64 targetSize, int depth, corpus::Generator& gen)
+{
+    const qint64 nodeSize = 40;
+
+    int fanout = 1;
+    for (; qint64(fanout) * nodeSize < targetSize; ++fanout)
+    {
+        qint64 nodes = 0, level = 1;
+        for (int d = 0; d <= depth && nodes * nodeSize < targetSize; ++d, level *= fanout)
+            nodes += level;
+
+        if (nodes * nodeSize >= targetSize)
+            break;
+    }
+
+    corpus::Filler::Params params;
+    params.budget   = targetSize;
+    params.maxDepth = depth;
+    params.fanout   = fanout;
+    params.optional = 0.8;
+    return corpus::Filler::make<Node>(gen, params);
+}
+
+// Chain of nodes with one child each
+Node makeChain(int depth, corpus::Generator& gen)
+{
+    corpus::Filler::Params params;
+    params.maxDepth = depth;
+    params.fanout   = 1;
+    params.optional = 0.8;
+    return corpus::Filler::make<Node>(gen, params);
+}
+
+//---------------------------------- Runner ---------------------------------
+
+struct Stat
+{
+    std::string corpus;
+    std::string operation;
+    qint64 bucket = {0};   // Bucket size (bytes or depth)
+    qint64 bytes  = {0};   // Average document size
+    size_t count  = {0};
+    double p50 = {0}, p90 = {0}, p99 = {0}, max = {0}; // Nanoseconds
+};
+
+std::vector<Stat> stats;
+
+Stat makeStat(const std::string& corpusName, const std::string& operation,
+              qint64 bucket, qint64 bytes, std::vector<double>& times)
+{
+    std::sort(times.begin(), times.end());
+    auto percentile = [&times](double q)
+    {
+        return times[std::min(times.size() - 1, size_t(q * (times.size() - 1) + 0.5))];
+    };
+
+    Stat s;
+    s.corpus    = corpusName;
+    s.operation = operation;
+    s.bucket    = bucket;
+    s.bytes     = bytes;
+    s.count     = times.size();
+    s.p50       = percentile(0.50);
+    s.p90       = percentile(0.90);
+    s.p99       = percentile(0.99);
+    s.max       = times.back();
+    return s;
+}
+
+template<typename Func>
+double measure(Func func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+// Replays documents of one bucket through fromJson()/toJson(), valid
+// documents must be accepted, near-valid ones must be rejected
+template<typename T>
+void replay(const std::string& corpusName, qint64 bucket,
+            const std::vector<QByteArray>& valid, const std::vector<QByteArray>& invalid)
+{
+    std::vector<double> fromTimes, toTimes, invalidTimes;
+    qint64 bytes = 0;
+
+    for (const QByteArray& json : valid)
+    {
+        T obj;
+        bool result = false;
+        fromTimes.push_back(measure([&] {result = bool(obj.fromJson(json));}));
+        REQUIRE( result == true );
+
+        QByteArray out;
+        toTimes.push_back(measure([&] {out = obj.toJson();}));
+        REQUIRE( out.size() > 0 );
+
+        bytes += json.size();
+    }
+
+    for (const QByteArray& json : invalid)
+    {
+        T obj;
+        bool result = true;
+        invalidTimes.push_back(measure([&] {result = bool(obj.fromJson(json));}));
+        REQUIRE( result == false );
+    }
+
+    bytes /= qint64(valid.size());
+    stats.push_back(makeStat(corpusName, "fromJson", bucket, bytes, fromTimes));
+    stats.push_back(makeStat(corpusName, "toJson", bucket, bytes, toTimes));
+    if (!invalidTimes.empty())
+        stats.push_back(makeStat(corpusName, "fromJson invalid", bucket, bytes, invalidTimes));
+}
+
+// Number of documents in a bucket: many small ones, a few large ones
+int docsCount(qint64 size)
+{
+    return int(std::max<qint64>(3, std::min<qint64>(200, 4 * 1024 * 1024 / size)));
+}
+
+std::vector<qint64> sizeBuckets()
+{
+    std::vector<qint64> buckets;
+    for (qint64 size = 100; size <= corpusMaxSize; size *= 10)
+        buckets.push_back(size);
+
+    // Tail bucket (for example 50 MB after 10 MB), a size close to the last
+    // decade bucket would only repeat the most expensive run
+    if (buckets.empty() || buckets.back() * 2 < corpusMaxSize)
+        buckets.push_back(corpusMaxSize);
+
+    return buckets;
+}
+
+void printStats()
+{
+    if (stats.empty())
+        return;
+
+    // The table goes to stderr, as the one of the throughput listener:
+    // stdout may be taken by a machine-readable reporter
+    std::fprintf(stderr, "\n%-8s %-17s %10s %10s %6s %12s %12s %12s %12s %10s\n",
+                 "Corpus", "Operation", "Bucket", "Bytes", "Docs",
+                 "p50 us", "p90 us", "p99 us", "max us", "p50 ns/B");
+
+    for (const Stat& s : stats)
+        std::fprintf(stderr, "%-8s %-17s %10lld %10lld %6zu %12.1f %12.1f %12.1f %12.1f %10.2f\n",
+                     s.corpus.c_str(), s.operation.c_str(),
+                     (long long) s.bucket, (long long) s.bytes, s.count,
+                     s.p50 / 1e3, s.p90 / 1e3, s.p99 / 1e3, s.max / 1e3,
+                     (s.bytes > 0) ? s.p50 / s.bytes : 0.);
+
+    if (corpusOut.empty())
+        return;
+
+    std::ofstream out {corpusOut, std::ios::trunc};
+    out << "corpus,operation,bucket,bytes,docs,p50_ns,p90_ns,p99_ns,max_ns\n";
+    for (const Stat& s : stats)
+        out << s.corpus    << ','
+            << s.operation << ','
+            << s.bucket    << ','
+            << s.bytes     << ','
+            << s.count     << ','
+            << s.p50       << ','
+            << s.p90       << ','
+            << s.p99       << ','
+            << s.max       << '\n';
+}
+
+} // namespace
+
+TEST_CASE( "Corpus of flat records", "[corpus][json]" )
+{
+    using namespace pproto::data;
+
+    corpus::Generator gen {corpusSeed};
+
+    for (qint64 size : sizeBuckets())
+    {
+        std::vector<QByteArray> valid, invalid;
+        for (int i = 0; i < docsCount(size); ++i)
+        {
+            QByteArray json = makeRecList(size, gen).toJson();
+            invalid.push_back(corpus::dropKey(json, "id", gen));
+            invalid.push_back(corpus::truncate(json, gen));
+            invalid.push_back(corpus::unbalance(json));
+            valid.push_back(json);
+        }
+        replay<RecList>("records", size, valid, invalid);
+    }
+}
+
+TEST_CASE( "Corpus of trees", "[corpus][json]" )
+{
+    using namespace pproto::data;
+
+    corpus::Generator gen {corpusSeed};
+
+    for (qint64 size : sizeBuckets())
+    {
+        std::vector<QByteArray> valid, invalid;
+        for (int i = 0; i < docsCount(size); ++i)
+        {
+            QByteArray json = makeTree(size, corpusTreeDepth, gen).toJson();
+            invalid.push_back(corpus::dropKey(json, "id", gen));
+            invalid.push_back(corpus::truncate(json, gen));
+            valid.push_back(json);
+        }
+        replay<Node>("tree", size, valid, invalid);
+    }
+}
+
+TEST_CASE( "Corpus of deep chains", "[corpus][json]" )
+{
+    using namespace pproto::data;
+
+    corpus::Generator gen {corpusSeed};
+
+    // The bucket is the nesting depth, the size of the document grows
+    // linearly, so the time per byte must stay flat
+    for (int depth = 1; depth <= corpusDepth; depth *= 4)
+    {
+        std::vector<QByteArray> valid, invalid;
+        for (int i = 0; i < 20; ++i)
+        {
+            QByteArray json = makeChain(depth, gen).toJson();
+            invalid.push_back(corpus::truncate(json, gen));
+            valid.push_back(json);
+        }
+        replay<Node>("chain", depth, valid, invalid);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Savers are not added: rejected near-valid documents are logged
+    // by the reader, the log is not needed here
+    alog::logger().start();
+
+    Catch::Session session;
+
+    using namespace Catch::Clara;
+    auto cli = session.cli()
+        | Opt(corpusSeed, "seed")
+             ["--corpus-seed"]
+             ("seed of the corpus generator")
+        | Opt(corpusMaxSize, "bytes")
+             ["--corpus-max-size"]
+             ("size of the largest document (default 10 MB)")
+        | Opt(corpusDepth, "depth")
+             ["--corpus-depth"]
+             ("nesting depth of the deepest chain (default 256)")
+        | Opt(corpusTreeDepth, "depth")
+             ["--corpus-tree-depth"]
+             ("depth of the trees (default 6)")
+        | Opt(corpusOut, "file")
+             ["--corpus-out"]
+             ("write latency percentiles as CSV to the file");
+
+    session.cli(cli);
+
+    int result = session.applyCommandLine(argc, argv);
+    if (result == 0)
+    {
+        if (corpusMaxSize <= 0)
+        {
+            std::fprintf(stderr, "--corpus-max-size must be positive\n");
+            result = 1;
+        }
+        if (corpusDepth < 1)
+        {
+            std::fprintf(stderr, "--corpus-depth must be at least 1\n");
+            result = 1;
+        }
+        if (corpusTreeDepth < 1)
+        {
+            std::fprintf(stderr, "--corpus-tree-depth must be at least 1\n");
+            result = 1;
+        }
+    }
+    if (result == 0)
+        result = session.run();
+
+    printStats();
+
+    alog::stop();
+
+    return result;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "shared/logger/logger.h"
+#include "pproto/serialize/json.h"
+
+#include "catch2/bench_listener.h"
+#include "catch2/log_saver.h"
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+
+#include <string>
+
+namespace pproto {
+namespace data {
+
+template<typename ListT>
+struct L
+{
+    ListT list;
+    J_SERIALIZE_ONE( list )
+};
+
+} // namespace data
+} // namespace pproto
+
+namespace bench {
+
+template<typename T>
+void toJson(T& obj, size_t items, const std::string& name = "toJson")
+{
+    bench::payload(obj.toJson().size(), items);
+
+    BENCHMARK( name + " " + std::to_string(items) )
+    {
+        return obj.toJson();
+    };
+}
+
+template<typename T>
+void fromJson(const QByteArray& json, size_t items, const std::string& name = "fromJson")
+{
+    {
+        T obj;
+        pproto::SResult sr = obj.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+    }
+
+    bench::payload(json.size(), items);
+
+    BENCHMARK( name + " " + std::to_string(items) )
+    {
+        T obj;
+        return bool(obj.fromJson(json));
+    };
+}
+
+} // namespace bench
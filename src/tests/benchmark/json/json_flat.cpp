@@ -0,0 +1,100 @@
+#include "benchmark/json/common.h"
+#include "catch2/catch_session.hpp"
+#include "catch2/generators/catch_generators.hpp"
+
+namespace pproto {
+namespace data {
+
+struct A
+{
+    qint32     p1 = {0};
+    QString    p2;
+    QByteArray p3;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+        J_SERIALIZE_ITEM( p3 )
+    J_SERIALIZE_END
+};
+
+// Fixed-shape record with scalar fields only (time, id, value), the
+// row-wise baseline for bulk lists of small records
+struct S
+{
+    qint64 time  = {0};
+    qint32 id    = {0};
+    double value = {0};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( time  )
+        J_SERIALIZE_ITEM( id    )
+        J_SERIALIZE_ITEM( value )
+    J_SERIALIZE_END
+};
+
+} // namespace data
+} // namespace pproto
+
+void run(int count)
+{
+    using namespace pproto::data;
+
+    L<QList<A>> l;
+    for (int i = 0; i < count; ++i)
+        l.list.append({i, QString("string %1").arg(i), QByteArray::number(i * 10)});
+
+    bench::toJson(l, count);
+    bench::fromJson<L<QList<A>>>(l.toJson(), count);
+}
+
+void runScalar(int count)
+{
+    using namespace pproto::data;
+
+    L<QList<S>> l;
+    for (int i = 0; i < count; ++i)
+        l.list.append({1700000000000ll + i, i, i * 0.25});
+
+    bench::toJson(l, count);
+    bench::fromJson<L<QList<S>>>(l.toJson(), count);
+}
+
+TEST_CASE( "Flat structure", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    run(count);
+}
+
+TEST_CASE( "Flat structure (1M items)", "[.][benchmark][json][large]" )
+{
+    run(1000000);
+}
+
+TEST_CASE( "Flat scalar structure", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    runScalar(count);
+}
+
+TEST_CASE( "Flat scalar structure (1M items)", "[.][benchmark][json][large]" )
+{
+    runScalar(1000000);
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    Catch::Session session;
+    int result = bench::applyCommandLine(session, argc, argv);
+    if (result == 0)
+        result = session.run();
+
+    alog::stop();
+
+    return result;
+}
@@ -0,0 +1,96 @@
+#include "shared/list.h"
+#include "shared/clife_base.h"
+#include "shared/clife_ptr.h"
+#include "shared/clife_alloc.h"
+#include "benchmark/json/common.h"
+#include "catch2/catch_session.hpp"
+#include "catch2/generators/catch_generators.hpp"
+
+namespace pproto {
+namespace data {
+
+struct A
+{
+    qint32  p1 = {0};
+    QString p2 = {"a"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_OPT ( p2 )
+    J_SERIALIZE_END
+};
+
+struct B : clife_base
+{
+    typedef clife_ptr<B> Ptr;
+
+    qint32  p1 = {0};
+    QString p2 = {"b"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_OPT ( p2 )
+    J_SERIALIZE_END
+};
+
+} // namespace data
+} // namespace pproto
+
+template<typename ListT>
+void run(int count)
+{
+    using namespace pproto::data;
+
+    L<ListT> l;
+    for (int i = 0; i < count; ++i)
+    {
+        auto* item = l.list.add();
+        item->p1 = i;
+        item->p2 = QString("item %1").arg(i);
+    }
+
+    bench::toJson(l, count);
+    bench::fromJson<L<ListT>>(l.toJson(), count);
+}
+
+TEST_CASE( "lst::List<A>", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    run<lst::List<pproto::data::A>>(count);
+}
+
+TEST_CASE( "lst::List<B> (B derived from clife_base)", "[benchmark][json]" )
+{
+    using namespace pproto::data;
+
+    int count = GENERATE( 1, 100, 10000 );
+    run<lst::List<B, clife_alloc<B>>>(count);
+}
+
+TEST_CASE( "lst::List<A> (1M items)", "[.][benchmark][json][large]" )
+{
+    run<lst::List<pproto::data::A>>(1000000);
+}
+
+TEST_CASE( "lst::List<B> (1M items)", "[.][benchmark][json][large]" )
+{
+    using namespace pproto::data;
+    run<lst::List<B, clife_alloc<B>>>(1000000);
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    Catch::Session session;
+    int result = bench::applyCommandLine(session, argc, argv);
+    if (result == 0)
+        result = session.run();
+
+    alog::stop();
+
+    return result;
+}
@@ -0,0 +1,81 @@
+#include "benchmark/json/common.h"
+#include "catch2/catch_session.hpp"
+#include "catch2/generators/catch_generators.hpp"
+
+#include <map>
+
+namespace pproto {
+namespace data {
+
+struct A
+{
+    qint32  p1 = {0};
+    QString p2 = {"str"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_OPT ( p2 )
+    J_SERIALIZE_END
+};
+
+template<typename MapT>
+struct M
+{
+    MapT map;
+    J_SERIALIZE_ONE( map )
+};
+
+} // namespace data
+} // namespace pproto
+
+template<typename MapT>
+void run(int count)
+{
+    using namespace pproto::data;
+
+    M<MapT> m;
+    for (int i = 0; i < count; ++i)
+        m.map[i] = A{i * 10, QString("mp%1").arg(i)};
+
+    bench::toJson(m, count);
+    bench::fromJson<M<MapT>>(m.toJson(), count);
+}
+
+TEST_CASE( "QMap<int, A>", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    run<QMap<int, pproto::data::A>>(count);
+}
+
+TEST_CASE( "std::map<int, A>", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    run<std::map<int, pproto::data::A>>(count);
+}
+
+TEST_CASE( "QMap<int, A> (1M items)", "[.][benchmark][json][large]" )
+{
+    run<QMap<int, pproto::data::A>>(1000000);
+}
+
+TEST_CASE( "std::map<int, A> (1M items)", "[.][benchmark][json][large]" )
+{
+    run<std::map<int, pproto::data::A>>(1000000);
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    Catch::Session session;
+    int result = bench::applyCommandLine(session, argc, argv);
+    if (result == 0)
+        result = session.run();
+
+    alog::stop();
+
+    return result;
+}
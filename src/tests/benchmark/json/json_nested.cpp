@@ -0,0 +1,111 @@
+#include "benchmark/json/common.h"
+#include "catch2/catch_session.hpp"
+#include "catch2/generators/catch_generators.hpp"
+
+namespace pproto {
+namespace data {
+
+struct Asub
+{
+    qint64 v1 = {0};
+    double v2 = {0};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( v1 )
+        J_SERIALIZE_ITEM( v2 )
+    J_SERIALIZE_END
+};
+
+struct A2
+{
+    qint32  p1 = {0};
+    QString p2;
+    Asub    p3;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+        J_SERIALIZE_ITEM( p3 )
+    J_SERIALIZE_END
+};
+
+struct A3
+{
+    qint32      p1 = {0};
+    QString     p2;
+    QList<Asub> p3;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+        J_SERIALIZE_ITEM( p3 )
+    J_SERIALIZE_END
+};
+
+} // namespace data
+} // namespace pproto
+
+void runStruct(int count)
+{
+    using namespace pproto::data;
+
+    L<QList<A2>> l;
+    for (int i = 0; i < count; ++i)
+        l.list.append({i, QString("string %1").arg(i), {i * 10, i * 0.5}});
+
+    bench::toJson(l, count);
+    bench::fromJson<L<QList<A2>>>(l.toJson(), count);
+}
+
+void runList(int count)
+{
+    using namespace pproto::data;
+
+    A3 a;
+    a.p1 = 10;
+    a.p2 = "string";
+    for (int i = 0; i < count; ++i)
+        a.p3.append({i, i * 0.5});
+
+    bench::toJson(a, count);
+    bench::fromJson<A3>(a.toJson(), count);
+}
+
+TEST_CASE( "Nested structure", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    runStruct(count);
+}
+
+TEST_CASE( "Nested list of structures", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    runList(count);
+}
+
+TEST_CASE( "Nested structure (1M items)", "[.][benchmark][json][large]" )
+{
+    runStruct(1000000);
+}
+
+TEST_CASE( "Nested list of structures (1M items)", "[.][benchmark][json][large]" )
+{
+    runList(1000000);
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    Catch::Session session;
+    int result = bench::applyCommandLine(session, argc, argv);
+    if (result == 0)
+        result = session.run();
+
+    alog::stop();
+
+    return result;
+}
@@ -0,0 +1,84 @@
+#include "benchmark/json/common.h"
+#include "catch2/catch_session.hpp"
+#include "catch2/generators/catch_generators.hpp"
+
+namespace pproto {
+namespace data {
+
+struct A
+{
+    qint32   p1 = {5};
+    QString  p2 = {"string1"};
+    qint64   p3 = {10};
+    QString  p4 = {"string2"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_OPT ( p2 )
+        J_SERIALIZE_ITEM( p3 )
+        J_SERIALIZE_OPT ( p4 )
+    J_SERIALIZE_END
+};
+
+} // namespace data
+} // namespace pproto
+
+void run(int count)
+{
+    using namespace pproto::data;
+
+    L<QList<A>> l;
+    for (int i = 0; i < count; ++i)
+        l.list.append({i, QString("string %1").arg(i), i * 10, QString("string %1").arg(i + 1)});
+
+    bench::toJson(l, count);
+
+    // Odd items skip the optional fields, items divisible by 6 have them
+    // as NULL, the rest of the even items have them set
+    QByteArray json = R"({"list":[)";
+    for (int i = 0; i < count; ++i)
+    {
+        if (i != 0)
+            json += ',';
+
+        json += R"({"p1":)" + QByteArray::number(i);
+        if (i % 2 == 0)
+            json += (i % 3 == 0) ? R"(,"p2":null)" : R"(,"p2":"string")";
+        json += R"(,"p3":)" + QByteArray::number(i * 10);
+        if (i % 2 == 0)
+            json += (i % 3 == 0) ? R"(,"p4":null})" : R"(,"p4":"string"})";
+        else
+            json += '}';
+    }
+    json += "]}";
+
+    bench::fromJson<L<QList<A>>>(json, count);
+}
+
+TEST_CASE( "Structure with optional fields", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    run(count);
+}
+
+TEST_CASE( "Structure with optional fields (1M items)", "[.][benchmark][json][large]" )
+{
+    run(1000000);
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    Catch::Session session;
+    int result = bench::applyCommandLine(session, argc, argv);
+    if (result == 0)
+        result = session.run();
+
+    alog::stop();
+
+    return result;
+}
@@ -0,0 +1,106 @@
+#include "shared/clife_base.h"
+#include "shared/clife_ptr.h"
+#include "shared/container_ptr.h"
+#include "benchmark/json/common.h"
+#include "catch2/catch_session.hpp"
+#include "catch2/generators/catch_generators.hpp"
+
+namespace pproto {
+namespace data {
+
+struct A : clife_base
+{
+    typedef clife_ptr<A> Ptr;
+
+    qint32  v1 = {0};
+    QString v2 = {"str 1234"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( v1 )
+        J_SERIALIZE_OPT ( v2 )
+    J_SERIALIZE_END
+};
+
+struct B
+{
+    typedef container_ptr<B> Ptr;
+
+    qint64  v1 = {0};
+    QString v2 = {"str 5678"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( v1 )
+        J_SERIALIZE_OPT ( v2 )
+    J_SERIALIZE_END
+};
+
+struct D
+{
+    qint32  p1 = {0};
+    QString p2 = {"5678"};
+    A::Ptr  p3;
+    B::Ptr  p4;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+        J_SERIALIZE_OPT ( p3 )
+        J_SERIALIZE_OPT ( p4 )
+    J_SERIALIZE_END
+};
+
+} // namespace data
+} // namespace pproto
+
+void run(int count)
+{
+    using namespace pproto::data;
+
+    // Every fourth item has both smart-pointers empty
+    L<QList<D>> l;
+    for (int i = 0; i < count; ++i)
+    {
+        D d;
+        d.p1 = i;
+        d.p2 = QString("string %1").arg(i);
+        if (i % 4 != 0)
+        {
+            d.p3 = A::Ptr{new A};
+            d.p3->v1 = i;
+            d.p4 = B::Ptr{new B};
+            d.p4->v1 = -i;
+        }
+        l.list.append(d);
+    }
+
+    bench::toJson(l, count);
+    bench::fromJson<L<QList<D>>>(l.toJson(), count);
+}
+
+TEST_CASE( "Structure with smart-pointer fields", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    run(count);
+}
+
+TEST_CASE( "Structure with smart-pointer fields (1M items)", "[.][benchmark][json][large]" )
+{
+    run(1000000);
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    Catch::Session session;
+    int result = bench::applyCommandLine(session, argc, argv);
+    if (result == 0)
+        result = session.run();
+
+    alog::stop();
+
+    return result;
+}
@@ -0,0 +1,216 @@
+#include "benchmark/json/common.h"
+#include "catch2/catch_session.hpp"
+#include "catch2/generators/catch_generators.hpp"
+
+namespace pproto {
+namespace data {
+
+struct W
+{
+    qint32  f01 = {0};
+    qint32  f02 = {0};
+    qint32  f03 = {0};
+    qint32  f04 = {0};
+    qint32  f05 = {0};
+    qint32  f06 = {0};
+    qint32  f07 = {0};
+    qint32  f08 = {0};
+    qint32  f09 = {0};
+    qint32  f10 = {0};
+    qint32  f11 = {0};
+    qint32  f12 = {0};
+    qint32  f13 = {0};
+    qint32  f14 = {0};
+    qint32  f15 = {0};
+    qint32  f16 = {0};
+    qint32  f17 = {0};
+    qint32  f18 = {0};
+    qint32  f19 = {0};
+    qint32  f20 = {0};
+    double  f21 = {0};
+    double  f22 = {0};
+    double  f23 = {0};
+    double  f24 = {0};
+    double  f25 = {0};
+    double  f26 = {0};
+    double  f27 = {0};
+    double  f28 = {0};
+    double  f29 = {0};
+    double  f30 = {0};
+    QString f31;
+    QString f32;
+    QString f33;
+    QString f34;
+    QString f35;
+    QString f36;
+    QString f37;
+    QString f38;
+    QString f39;
+    QString f40;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( f01 )
+        J_SERIALIZE_ITEM( f02 )
+        J_SERIALIZE_ITEM( f03 )
+        J_SERIALIZE_ITEM( f04 )
+        J_SERIALIZE_ITEM( f05 )
+        J_SERIALIZE_ITEM( f06 )
+        J_SERIALIZE_ITEM( f07 )
+        J_SERIALIZE_ITEM( f08 )
+        J_SERIALIZE_ITEM( f09 )
+        J_SERIALIZE_ITEM( f10 )
+        J_SERIALIZE_ITEM( f11 )
+        J_SERIALIZE_ITEM( f12 )
+        J_SERIALIZE_ITEM( f13 )
+        J_SERIALIZE_ITEM( f14 )
+        J_SERIALIZE_ITEM( f15 )
+        J_SERIALIZE_ITEM( f16 )
+        J_SERIALIZE_ITEM( f17 )
+        J_SERIALIZE_ITEM( f18 )
+        J_SERIALIZE_ITEM( f19 )
+        J_SERIALIZE_ITEM( f20 )
+        J_SERIALIZE_ITEM( f21 )
+        J_SERIALIZE_ITEM( f22 )
+        J_SERIALIZE_ITEM( f23 )
+        J_SERIALIZE_ITEM( f24 )
+        J_SERIALIZE_ITEM( f25 )
+        J_SERIALIZE_ITEM( f26 )
+        J_SERIALIZE_ITEM( f27 )
+        J_SERIALIZE_ITEM( f28 )
+        J_SERIALIZE_ITEM( f29 )
+        J_SERIALIZE_ITEM( f30 )
+        J_SERIALIZE_ITEM( f31 )
+        J_SERIALIZE_ITEM( f32 )
+        J_SERIALIZE_ITEM( f33 )
+        J_SERIALIZE_ITEM( f34 )
+        J_SERIALIZE_ITEM( f35 )
+        J_SERIALIZE_ITEM( f36 )
+        J_SERIALIZE_ITEM( f37 )
+        J_SERIALIZE_ITEM( f38 )
+        J_SERIALIZE_ITEM( f39 )
+        J_SERIALIZE_ITEM( f40 )
+    J_SERIALIZE_END
+};
+
+} // namespace data
+} // namespace pproto
+
+pproto::data::W makeW(int i)
+{
+    using namespace pproto::data;
+
+    W w;
+    w.f01 = i + 1;
+    w.f02 = i + 2;
+    w.f03 = i + 3;
+    w.f04 = i + 4;
+    w.f05 = i + 5;
+    w.f06 = i + 6;
+    w.f07 = i + 7;
+    w.f08 = i + 8;
+    w.f09 = i + 9;
+    w.f10 = i + 10;
+    w.f11 = i + 11;
+    w.f12 = i + 12;
+    w.f13 = i + 13;
+    w.f14 = i + 14;
+    w.f15 = i + 15;
+    w.f16 = i + 16;
+    w.f17 = i + 17;
+    w.f18 = i + 18;
+    w.f19 = i + 19;
+    w.f20 = i + 20;
+    w.f21 = i + 21.5;
+    w.f22 = i + 22.5;
+    w.f23 = i + 23.5;
+    w.f24 = i + 24.5;
+    w.f25 = i + 25.5;
+    w.f26 = i + 26.5;
+    w.f27 = i + 27.5;
+    w.f28 = i + 28.5;
+    w.f29 = i + 29.5;
+    w.f30 = i + 30.5;
+    w.f31 = QString("string %1").arg(i + 31);
+    w.f32 = QString("string %1").arg(i + 32);
+    w.f33 = QString("string %1").arg(i + 33);
+    w.f34 = QString("string %1").arg(i + 34);
+    w.f35 = QString("string %1").arg(i + 35);
+    w.f36 = QString("string %1").arg(i + 36);
+    w.f37 = QString("string %1").arg(i + 37);
+    w.f38 = QString("string %1").arg(i + 38);
+    w.f39 = QString("string %1").arg(i + 39);
+    w.f40 = QString("string %1").arg(i + 40);
+    return w;
+}
+
+// Document with the keys in reverse order of declaration, peers
+// do not emit the keys in the order of J_SERIALIZE_ITEM
+QByteArray reversedJson(int count)
+{
+    QByteArray json = R"({"list":[)";
+    for (int i = 0; i < count; ++i)
+    {
+        if (i != 0)
+            json += ',';
+
+        json += '{';
+        for (int k = 40; k >= 1; --k)
+        {
+            QByteArray name = QByteArray::number(k).rightJustified(2, '0');
+            json += R"("f)" + name + R"(":)";
+            if (k <= 20)
+                json += QByteArray::number(i + k);
+            else if (k <= 30)
+                json += QByteArray::number(i + k + 0.5, 'g', 17);
+            else
+                json += R"("string )" + QByteArray::number(i + k) + '"';
+
+            if (k != 1)
+                json += ',';
+        }
+        json += '}';
+    }
+    json += "]}";
+    return json;
+}
+
+void run(int count)
+{
+    using namespace pproto::data;
+
+    L<QList<W>> l;
+    for (int i = 0; i < count; ++i)
+        l.list.append(makeW(i));
+
+    bench::toJson(l, count);
+    bench::fromJson<L<QList<W>>>(l.toJson(), count, "fromJson in-order");
+    bench::fromJson<L<QList<W>>>(reversedJson(count), count, "fromJson reversed");
+}
+
+TEST_CASE( "Wide structure (40 fields)", "[benchmark][json]" )
+{
+    int count = GENERATE( 1, 100, 10000 );
+    run(count);
+}
+
+TEST_CASE( "Wide structure (40 fields, 1M items)", "[.][benchmark][json][large]" )
+{
+    run(1000000);
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    Catch::Session session;
+    int result = bench::applyCommandLine(session, argc, argv);
+    if (result == 0)
+        result = session.run();
+
+    alog::stop();
+
+    return result;
+}
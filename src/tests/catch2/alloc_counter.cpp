@@ -0,0 +1,240 @@
+#include "catch2/alloc_counter.h"
+
+#include <malloc.h>
+#include <cerrno>
+#include <new>
+
+extern "C" {
+void* __libc_malloc(size_t);
+void* __libc_calloc(size_t, size_t);
+void* __libc_realloc(void*, size_t);
+void* __libc_memalign(size_t, size_t);
+void* __libc_valloc(size_t);
+void* __libc_pvalloc(size_t);
+void  __libc_free(void*);
+} // extern "C"
+
+namespace alloc {
+
+namespace {
+
+// Constant-initialized, so there is no TLS init function that could
+// recurse into malloc
+thread_local Counters counters;
+
+inline void countAlloc(void* p)
+{
+    if (p == nullptr)
+        return;
+
+    ++counters.allocs;
+    counters.allocBytes += malloc_usable_size(p);
+}
+
+inline bool isPowerOfTwo(size_t value)
+{
+    return (value != 0) && ((value & (value - 1)) == 0);
+}
+
+inline void countFree(void* p)
+{
+    if (p == nullptr)
+        return;
+
+    ++counters.frees;
+    counters.freeBytes += malloc_usable_size(p);
+}
+
+} // namespace
+
+Counters current()
+{
+    return counters;
+}
+
+Scope::Scope() : _start(counters)
+{}
+
+void Scope::reset()
+{
+    _start = counters;
+}
+
+size_t Scope::allocs() const
+{
+    return counters.allocs - _start.allocs;
+}
+
+size_t Scope::frees() const
+{
+    return counters.frees - _start.frees;
+}
+
+size_t Scope::bytes() const
+{
+    return counters.allocBytes - _start.allocBytes;
+}
+
+ptrdiff_t Scope::liveBlocks() const
+{
+    return ptrdiff_t(allocs()) - ptrdiff_t(frees());
+}
+
+ptrdiff_t Scope::liveBytes() const
+{
+    return ptrdiff_t(bytes()) - ptrdiff_t(counters.freeBytes - _start.freeBytes);
+}
+
+} // namespace alloc
+
+//----------------------------- malloc family -------------------------------
+
+extern "C" {
+
+void* malloc(size_t size) noexcept
+{
+    void* p = __libc_malloc(size);
+    alloc::countAlloc(p);
+    return p;
+}
+
+void* calloc(size_t num, size_t size) noexcept
+{
+    void* p = __libc_calloc(num, size);
+    alloc::countAlloc(p);
+    return p;
+}
+
+void* realloc(void* ptr, size_t size) noexcept
+{
+    // Realloc is counted as free of the old block and allocation of the new
+    // one: it may move the data, and it is what a growing buffer costs
+    if (ptr && size == 0)
+    {
+        alloc::countFree(ptr);
+        return __libc_realloc(ptr, size);
+    }
+
+    size_t oldBytes = ptr ? malloc_usable_size(ptr) : 0;
+    void* p = __libc_realloc(ptr, size);
+    if (p == nullptr)
+        return nullptr;
+
+    if (ptr)
+    {
+        ++alloc::counters.frees;
+        alloc::counters.freeBytes += oldBytes;
+    }
+    alloc::countAlloc(p);
+    return p;
+}
+
+void* reallocarray(void* ptr, size_t num, size_t size) noexcept
+{
+    size_t bytes;
+    if (__builtin_mul_overflow(num, size, &bytes))
+    {
+        errno = ENOMEM;
+        return nullptr;
+    }
+    return realloc(ptr, bytes);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept
+{
+    void* p = __libc_memalign(alignment, size);
+    alloc::countAlloc(p);
+    return p;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept
+{
+    if (!alloc::isPowerOfTwo(alignment))
+    {
+        errno = EINVAL;
+        return nullptr;
+    }
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** memptr, size_t alignment, size_t size) noexcept
+{
+    if (!alloc::isPowerOfTwo(alignment) || (alignment % sizeof(void*) != 0))
+        return EINVAL;
+
+    void* p = memalign(alignment, size);
+    if (p == nullptr)
+        return ENOMEM;
+
+    *memptr = p;
+    return 0;
+}
+
+void* valloc(size_t size) noexcept
+{
+    void* p = __libc_valloc(size);
+    alloc::countAlloc(p);
+    return p;
+}
+
+void* pvalloc(size_t size) noexcept
+{
+    void* p = __libc_pvalloc(size);
+    alloc::countAlloc(p);
+    return p;
+}
+
+void free(void* ptr) noexcept
+{
+    alloc::countFree(ptr);
+    __libc_free(ptr);
+}
+
+} // extern "C"
+
+//------------------------- operator new / delete ---------------------------
+
+void* operator new(size_t size)
+{
+    if (void* p = malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return malloc(size ? size : 1);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return malloc(size ? size : 1);
+}
+
+void* operator new(size_t size, std::align_val_t al)
+{
+    if (void* p = memalign(size_t(al), size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t al)
+{
+    return operator new(size, al);
+}
+
+void operator delete(void* p) noexcept                             {free(p);}
+void operator delete[](void* p) noexcept                           {free(p);}
+void operator delete(void* p, size_t) noexcept                     {free(p);}
+void operator delete[](void* p, size_t) noexcept                   {free(p);}
+void operator delete(void* p, const std::nothrow_t&) noexcept      {free(p);}
+void operator delete[](void* p, const std::nothrow_t&) noexcept    {free(p);}
+void operator delete(void* p, std::align_val_t) noexcept           {free(p);}
+void operator delete[](void* p, std::align_val_t) noexcept         {free(p);}
+void operator delete(void* p, size_t, std::align_val_t) noexcept   {free(p);}
+void operator delete[](void* p, size_t, std::align_val_t) noexcept {free(p);}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+
+namespace alloc {
+
+// Allocation counters of the current thread. All heap allocations are
+// counted: malloc/calloc/realloc/reallocarray, memalign/aligned_alloc/
+// posix_memalign/valloc/pvalloc (interposed over glibc) and global
+// operator new/delete. Bytes are counted by malloc_usable_size()
+struct Counters
+{
+    size_t allocs     = {0};
+    size_t frees      = {0};
+    size_t allocBytes = {0};
+    size_t freeBytes  = {0};
+};
+
+Counters current();
+
+// Counts allocations of the current thread from the moment of creation
+// (or of the last reset() call). Allocations made by other threads,
+// for example by the logger thread, are not counted
+class Scope
+{
+public:
+    Scope();
+    void reset();
+
+    size_t allocs() const;
+    size_t frees() const;
+    size_t bytes() const;
+
+    // Blocks and bytes allocated in the scope and not yet freed
+    ptrdiff_t liveBlocks() const;
+    ptrdiff_t liveBytes() const;
+
+private:
+    Counters _start;
+};
+
+} // namespace alloc
@@ -0,0 +1,152 @@
+#include "catch2/bench_listener.h"
+#include "catch2/catch_session.hpp"
+#include "catch2/catch_test_case_info.hpp"
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/internal/catch_clara.hpp"
+#include "catch2/reporters/catch_reporter_event_listener.hpp"
+#include "catch2/reporters/catch_reporter_registrars.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace bench {
+
+namespace {
+
+struct Payload
+{
+    size_t bytes = {0};
+    size_t items = {0};
+};
+
+struct Result
+{
+    std::string testCase;
+    std::string benchmark;
+    Payload     payload;
+    double      meanNs   = {0};
+    double      stddevNs = {0};
+    unsigned    samples  = {0};
+};
+
+Payload     currentPayload;
+std::string outputFile;
+std::string outputLabel;
+
+double perSecond(double value, double ns)
+{
+    return (ns > 0) ? (value * 1e9 / ns) : 0;
+}
+
+// CSV field in quotes, embedded quotes are doubled
+std::string csvQuoted(const std::string& field)
+{
+    std::string result = "\"";
+    for (char c : field)
+    {
+        if (c == '"')
+            result += '"';
+        result += c;
+    }
+    result += '"';
+    return result;
+}
+
+} // namespace
+
+void payload(size_t bytes, size_t items)
+{
+    currentPayload.bytes = bytes;
+    currentPayload.items = items;
+}
+
+int applyCommandLine(Catch::Session& session, int argc, char* argv[])
+{
+    using namespace Catch::Clara;
+
+    auto cli = session.cli()
+        | Opt(outputFile, "file")
+             ["--throughput-out"]
+             ("append throughput results as CSV rows to the file")
+        | Opt(outputLabel, "text")
+             ["--throughput-label"]
+             ("label of the throughput rows (revision, build config)");
+
+    session.cli(cli);
+    return session.applyCommandLine(argc, argv);
+}
+
+class ThroughputListener : public Catch::EventListenerBase
+{
+public:
+    using EventListenerBase::EventListenerBase;
+
+    void testCaseStarting(const Catch::TestCaseInfo& info) override
+    {
+        _testCase = info.name;
+    }
+
+    void benchmarkEnded(const Catch::BenchmarkStats<>& stats) override
+    {
+        Result r;
+        r.testCase  = _testCase;
+        r.benchmark = stats.info.name;
+        r.payload   = currentPayload;
+        r.meanNs    = stats.mean.point.count();
+        r.stddevNs  = stats.standardDeviation.point.count();
+        r.samples   = stats.info.samples;
+        _results.push_back(r);
+    }
+
+    void testRunEnded(const Catch::TestRunStats&) override
+    {
+        if (_results.empty())
+            return;
+
+        // The table goes to stderr: stdout may be taken by a machine-readable
+        // reporter (-r xml, -r json, -r junit)
+        std::fprintf(stderr, "\n%-40s %-22s %12s %12s %14s %14s\n",
+                     "Test case", "Benchmark", "Bytes", "MB/s", "msgs/s", "items/s");
+
+        for (const Result& r : _results)
+            std::fprintf(stderr, "%-40s %-22s %12zu %12.2f %14.0f %14.0f\n",
+                         r.testCase.c_str(), r.benchmark.c_str(), r.payload.bytes,
+                         perSecond(r.payload.bytes, r.meanNs) / 1e6,
+                         perSecond(1, r.meanNs),
+                         perSecond(r.payload.items, r.meanNs));
+
+        if (outputFile.empty())
+            return;
+
+        std::ifstream probe {outputFile};
+        bool writeHeader = !probe.good() || (probe.peek() == std::ifstream::traits_type::eof());
+        probe.close();
+
+        std::ofstream out {outputFile, std::ios::app};
+        if (writeHeader)
+            out << "label,test_case,benchmark,bytes,items,samples,"
+                   "mean_ns,stddev_ns,mb_per_s,msgs_per_s,items_per_s\n";
+
+        for (const Result& r : _results)
+            out << csvQuoted(outputLabel) << ','
+                << csvQuoted(r.testCase)  << ','
+                << csvQuoted(r.benchmark) << ','
+                << r.payload.bytes << ','
+                << r.payload.items << ','
+                << r.samples  << ','
+                << r.meanNs   << ','
+                << r.stddevNs << ','
+                << perSecond(r.payload.bytes, r.meanNs) / 1e6 << ','
+                << perSecond(1, r.meanNs) << ','
+                << perSecond(r.payload.items, r.meanNs) << '\n';
+    }
+
+private:
+    std::string _testCase;
+    std::vector<Result> _results;
+};
+
+CATCH_REGISTER_LISTENER(ThroughputListener)
+
+} // namespace bench
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <string>
+#include <cstddef>
+
+namespace Catch {
+class Session;
+} // namespace Catch
+
+namespace bench {
+
+// Sets the amount of data processed by one call of the next BENCHMARK.
+// Bytes is the size of the JSON document, items is the number of
+// elements (structures) in the document
+void payload(size_t bytes, size_t items = 1);
+
+// Adds the throughput options to the Catch2 command line and parses it:
+//   --throughput-out <file>    append results as CSV rows to the file
+//   --throughput-label <text>  label of the rows (PProtoCpp revision etc.)
+int applyCommandLine(Catch::Session&, int argc, char* argv[]);
+
+} // namespace bench
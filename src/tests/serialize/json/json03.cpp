@@ -86,6 +86,41 @@ TEST_CASE( "Deserialize optional fields", "[json]" )
         REQUIRE( a.p3 == 20        );
         REQUIRE( a.p4 == "string"  );
     }
+    SECTION( "Missing optional fields keep current values" )
+    {
+        QByteArray json = R"({"p1":10,"p3":20})";
+
+        A a;
+        a.p1 = 1;
+        a.p2 = "old2";
+        a.p3 = 2;
+        a.p4 = "old4";
+
+        pproto::SResult sr = a.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( a.p1 == 10     );
+        REQUIRE( a.p2 == "old2" ); // current value
+        REQUIRE( a.p3 == 20     );
+        REQUIRE( a.p4 == "old4" ); // current value
+    }
+    SECTION( "Repeated deserialization into the same object" )
+    {
+        A a;
+        pproto::SResult sr = a.fromJson(R"({"p1":10,"p2":"string","p3":20,"p4":"string"})");
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        sr = a.fromJson(R"({"p1":11,"p3":21,"p4":"string4"})");
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( a.p1 == 11        );
+        REQUIRE( a.p2 == "string"  ); // value of the first call
+        REQUIRE( a.p3 == 21        );
+        REQUIRE( a.p4 == "string4" );
+    }
     SECTION( "Filling out partially mandatory fields (skip p3 field)" )
     {
         QByteArray json = R"({"p1":10,"p2":"string"})";
@@ -277,6 +312,85 @@ TEST_CASE( "Deserialize list field from NULL", "[json]" )
     }
 }
 
+TEST_CASE( "Deserialize list field into non-empty list", "[json]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Incoming list is shorter" )
+    {
+        QByteArray json = R"(
+            {"v1":10,"v2":"string",
+             "v3":[{"p1":11,"p3":21}]}
+        )";
+
+        Alist al;
+        al.v3 = {{1, "123", 2, "345"}, {3, "456", 4, "789"}, {5, "012", 6, "345"}};
+
+        REQUIRE( al.v3.count() == 3 );
+
+        pproto::SResult sr = al.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( al.v3.count() == 1       );
+
+        REQUIRE( al.v3[0].p1 == 11        );
+        REQUIRE( al.v3[0].p2 == "string1" ); // default value, not "123"
+        REQUIRE( al.v3[0].p3 == 21        );
+        REQUIRE( al.v3[0].p4 == "string2" ); // default value, not "345"
+    }
+    SECTION( "Incoming list is longer" )
+    {
+        QByteArray json = R"(
+            {"v1":10,"v2":"string",
+             "v3":[{"p1":11,"p3":21},
+                   {"p1":12,"p2":"string2","p3":22},
+                   {"p1":13,"p3":23,"p4":"string3"}]}
+        )";
+
+        Alist al;
+        al.v3 = {{1, "123", 2, "345"}};
+
+        REQUIRE( al.v3.count() == 1 );
+
+        pproto::SResult sr = al.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( al.v3.count() == 3       );
+
+        REQUIRE( al.v3[0].p1 == 11        );
+        REQUIRE( al.v3[0].p2 == "string1" ); // default value
+        REQUIRE( al.v3[0].p3 == 21        );
+        REQUIRE( al.v3[0].p4 == "string2" ); // default value
+        REQUIRE( al.v3[1].p1 == 12        );
+        REQUIRE( al.v3[1].p2 == "string2" );
+        REQUIRE( al.v3[1].p3 == 22        );
+        REQUIRE( al.v3[1].p4 == "string2" ); // default value
+        REQUIRE( al.v3[2].p1 == 13        );
+        REQUIRE( al.v3[2].p2 == "string1" ); // default value
+        REQUIRE( al.v3[2].p3 == 23        );
+        REQUIRE( al.v3[2].p4 == "string3" );
+    }
+    SECTION( "Incoming list is empty" )
+    {
+        QByteArray json = R"(
+            {"v1":10,"v2":"string","v3":[]}
+        )";
+
+        Alist al;
+        al.v3 = {{1, "123", 2, "345"}, {3, "456", 4, "789"}};
+
+        REQUIRE( al.v3.count() == 2 );
+
+        pproto::SResult sr = al.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( al.v3.count() == 0 );
+    }
+}
+
 int main(int argc, char* argv[])
 {
     alog::logger().start();
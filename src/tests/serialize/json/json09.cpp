@@ -0,0 +1,234 @@
+#include "shared/logger/logger.h"
+#include "shared/logger/format.h"
+#include "pproto/serialize/json.h"
+
+#include "catch2/log_saver.h"
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+
+namespace pproto {
+namespace data {
+
+struct A
+{
+    qint32  p1 = {0};
+    QString p2 = {"str"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_OPT ( p2 )
+    J_SERIALIZE_END
+};
+
+struct B
+{
+    qint32   v1 = {0};
+    A        v2;
+    QList<A> v3;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( v1 )
+        J_SERIALIZE_ITEM( v2 )
+        J_SERIALIZE_OPT ( v3 )
+    J_SERIALIZE_END
+};
+
+struct W
+{
+    qint32  f1  = {0};
+    qint32  f2  = {0};
+    qint32  f3  = {0};
+    qint32  f4  = {0};
+    qint32  f5  = {0};
+    qint32  f6  = {0};
+    qint32  f7  = {0};
+    qint32  f8  = {0};
+    qint32  f9  = {0};
+    qint32  f10 = {0};
+    qint32  f11 = {0};
+    qint32  f12 = {0};
+    QString f13 = {"s13"};
+    QString f14 = {"s14"};
+    QString f15 = {"s15"};
+    QString f16 = {"s16"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( f1  )
+        J_SERIALIZE_ITEM( f2  )
+        J_SERIALIZE_ITEM( f3  )
+        J_SERIALIZE_ITEM( f4  )
+        J_SERIALIZE_ITEM( f5  )
+        J_SERIALIZE_ITEM( f6  )
+        J_SERIALIZE_ITEM( f7  )
+        J_SERIALIZE_ITEM( f8  )
+        J_SERIALIZE_ITEM( f9  )
+        J_SERIALIZE_ITEM( f10 )
+        J_SERIALIZE_ITEM( f11 )
+        J_SERIALIZE_ITEM( f12 )
+        J_SERIALIZE_OPT ( f13 )
+        J_SERIALIZE_OPT ( f14 )
+        J_SERIALIZE_OPT ( f15 )
+        J_SERIALIZE_OPT ( f16 )
+    J_SERIALIZE_END
+};
+
+} // namespace data
+} // namespace pproto
+
+TEST_CASE( "Deserialize with unknown fields", "[json]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Unknown scalar fields" )
+    {
+        QByteArray json = R"({"x1":1,"p1":10,"x2":"abc","x3":null,"p2":"string","x4":true})";
+
+        A a;
+        pproto::SResult sr = a.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( a.p1 == 10       );
+        REQUIRE( a.p2 == "string" );
+    }
+    SECTION( "Unknown object and array fields" )
+    {
+        QByteArray json = R"(
+            {"x1":{"p1":99,"p2":"x","x":{"y":[1,2,{"p1":98}]}},
+             "v1":10,
+             "x2":[{"v1":97},[],{},"]}",null],
+             "v2":{"p1":11,"x3":[{"p1":96}],"p2":"string1"},
+             "v3":[{"p1":12,"x4":{"p1":95}},{"x5":"}","p1":13,"p2":"string3"}],
+             "x6":{}}
+        )";
+
+        B b;
+        pproto::SResult sr = b.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( b.v1 == 10              );
+        REQUIRE( b.v2.p1 == 11           );
+        REQUIRE( b.v2.p2 == "string1"    );
+        REQUIRE( b.v3.count() == 2       );
+        REQUIRE( b.v3[0].p1 == 12        );
+        REQUIRE( b.v3[0].p2 == "str"     ); // default value
+        REQUIRE( b.v3[1].p1 == 13        );
+        REQUIRE( b.v3[1].p2 == "string3" );
+    }
+    SECTION( "Unknown fields do not replace mandatory fields" )
+    {
+        QByteArray json = R"({"v1":10,"V2":{"p1":11},"v2_":{"p1":12}})";
+
+        B b;
+        pproto::SResult sr = b.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE_FALSE( bool(sr) == true );
+    }
+}
+
+TEST_CASE( "Deserialize nested lists of structures", "[json]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Empty list" )
+    {
+        QByteArray json = R"({"v1":10,"v2":{"p1":11},"v3":[]})";
+
+        B b;
+        pproto::SResult sr = b.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( b.v1 == 10          );
+        REQUIRE( b.v2.p1 == 11       );
+        REQUIRE( b.v2.p2 == "str"    ); // default value
+        REQUIRE( b.v3.count() == 0   );
+    }
+    SECTION( "Mandatory field is missing in list item" )
+    {
+        QByteArray json = R"({"v1":10,"v2":{"p1":11},"v3":[{"p1":12},{"p2":"string"}]})";
+
+        B b;
+        pproto::SResult sr = b.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE_FALSE( bool(sr) == true );
+    }
+}
+
+TEST_CASE( "Deserialize fields in arbitrary order", "[json]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Reverse order" )
+    {
+        QByteArray json = R"({"v3":[{"p2":"string1","p1":12}],"v2":{"p2":"string","p1":11},"v1":10})";
+
+        B b;
+        pproto::SResult sr = b.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( b.v1 == 10              );
+        REQUIRE( b.v2.p1 == 11           );
+        REQUIRE( b.v2.p2 == "string"     );
+        REQUIRE( b.v3.count() == 1       );
+        REQUIRE( b.v3[0].p1 == 12        );
+        REQUIRE( b.v3[0].p2 == "string1" );
+    }
+    SECTION( "Wide structure, shuffled order" )
+    {
+        QByteArray json = R"(
+            {"f16":"a16","f1":1,"f11":11,"f9":9,"f14":"a14","f2":2,"f12":12,"f10":10,
+             "f3":3,"f8":8,"f5":5,"f7":7,"f4":4,"f6":6}
+        )";
+
+        W w;
+        pproto::SResult sr = w.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( w.f1  == 1     );
+        REQUIRE( w.f2  == 2     );
+        REQUIRE( w.f3  == 3     );
+        REQUIRE( w.f4  == 4     );
+        REQUIRE( w.f5  == 5     );
+        REQUIRE( w.f6  == 6     );
+        REQUIRE( w.f7  == 7     );
+        REQUIRE( w.f8  == 8     );
+        REQUIRE( w.f9  == 9     );
+        REQUIRE( w.f10 == 10    );
+        REQUIRE( w.f11 == 11    );
+        REQUIRE( w.f12 == 12    );
+        REQUIRE( w.f13 == "s13" ); // default value
+        REQUIRE( w.f14 == "a14" );
+        REQUIRE( w.f15 == "s15" ); // default value
+        REQUIRE( w.f16 == "a16" );
+    }
+    SECTION( "Wide structure, mandatory field is missing" )
+    {
+        QByteArray json = R"(
+            {"f12":12,"f11":11,"f10":10,"f9":9,"f8":8,"f7":7,
+             "f6":6,"f5":5,"f4":4,"f3":3,"f2":2,"f100":1}
+        )";
+
+        W w;
+        pproto::SResult sr = w.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE_FALSE( bool(sr) == true );
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    int result = Catch::Session().run(argc, argv);
+
+    alog::stop();
+
+    return result;
+}
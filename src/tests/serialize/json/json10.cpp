@@ -0,0 +1,132 @@
+#include "shared/logger/logger.h"
+#include "shared/logger/format.h"
+#include "pproto/serialize/json.h"
+
+#include "catch2/log_saver.h"
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+
+namespace pproto {
+namespace data {
+
+struct A
+{
+    qint32  p1 = {0};
+    QString p2;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+    J_SERIALIZE_END
+};
+
+} // namespace data
+} // namespace pproto
+
+TEST_CASE( "Serialize/Deserialize non-ASCII strings", "[json]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Serialize cyrillic string" )
+    {
+        A a;
+        a.p1 = 1;
+        a.p2 = QString::fromUtf8("строка 123");
+
+        QByteArray json = a.toJson();
+        REQUIRE( json == QByteArray(R"({"p1":1,"p2":"строка 123"})") );
+    }
+    SECTION( "Deserialize cyrillic string" )
+    {
+        QByteArray json = R"({"p1":1,"p2":"строка 123"})";
+
+        A a;
+        pproto::SResult sr = a.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( a.p2 == QString::fromUtf8("строка 123") );
+    }
+    SECTION( "Deserialize \\u-escaped string" )
+    {
+        QByteArray json = R"({"p1":1,"p2":"\u0441\u0442\u0440 \ud83d\ude00 \"q\" \\ \t"})";
+
+        A a;
+        pproto::SResult sr = a.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( a.p2 == QString::fromUtf8("стр 😀 \"q\" \\ \t") );
+    }
+    SECTION( "Round trip of 2, 3 and 4 byte UTF-8 sequences" )
+    {
+        A a;
+        a.p1 = 2;
+        a.p2 = QString::fromUtf8("ж € 😀 ab\"c\\d\ne\x01 жж€€😀😀");
+
+        QByteArray json = a.toJson();
+
+        A aa;
+        pproto::SResult sr = aa.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( aa.p1 == 2    );
+        REQUIRE( aa.p2 == a.p2 );
+    }
+    SECTION( "Round trip with non-ASCII char at every position" )
+    {
+        // The lengths cover the 16 and 32 byte boundaries of vectorized
+        // ASCII scanning, the non-ASCII char lands in the head, the body
+        // and the tail of the string
+        for (int len = 0; len <= 70; ++len)
+            for (int pos = 0; pos <= len; ++pos)
+            {
+                A a;
+                a.p1 = len;
+                a.p2 = QString(len, QChar('a'));
+                a.p2.insert(pos, QString::fromUtf8("ж"));
+
+                QByteArray json = a.toJson();
+
+                A aa;
+                pproto::SResult sr = aa.fromJson(json);
+
+                INFO( "len: " << len << ", pos: " << pos );
+                REQUIRE( bool(sr) == true );
+                REQUIRE( aa.p2 == a.p2 );
+            }
+        ALOG_FLUSH();
+    }
+    SECTION( "Round trip of long ASCII string" )
+    {
+        A a;
+        a.p1 = 3;
+        for (int i = 0; i < 1000; ++i)
+            a.p2 += QChar('a' + (i % 26));
+
+        QByteArray json = a.toJson();
+        REQUIRE( json == R"({"p1":3,"p2":")" + a.p2.toUtf8() + R"("})" );
+
+        A aa;
+        pproto::SResult sr = aa.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+
+        REQUIRE( aa.p2 == a.p2 );
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    int result = Catch::Session().run(argc, argv);
+
+    alog::stop();
+
+    return result;
+}
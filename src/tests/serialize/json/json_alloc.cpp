@@ -0,0 +1,529 @@
+#include "shared/list.h"
+#include "shared/clife_base.h"
+#include "shared/clife_ptr.h"
+#include "shared/clife_alloc.h"
+#include "shared/container_ptr.h"
+#include "shared/logger/logger.h"
+#include "shared/logger/format.h"
+#include "pproto/serialize/json.h"
+
+#include "catch2/alloc_counter.h"
+#include "catch2/log_saver.h"
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+
+namespace pproto {
+namespace data {
+
+struct A
+{
+    qint32     p1 = {0};
+    QString    p2;
+    QByteArray p3;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+        J_SERIALIZE_ITEM( p3 )
+    J_SERIALIZE_END
+};
+
+struct Asub
+{
+    qint64 v1 = {0};
+    double v2 = {0};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( v1 )
+        J_SERIALIZE_ITEM( v2 )
+    J_SERIALIZE_END
+};
+
+struct A3
+{
+    qint32      p1 = {0};
+    QString     p2;
+    QList<Asub> p3;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+        J_SERIALIZE_ITEM( p3 )
+    J_SERIALIZE_END
+};
+
+// Nested optional structure, as DA/DAopt of Json 05
+struct Asub2
+{
+    qint32  v1 = {1};
+    QString v2 = {"str 1234"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( v1 )
+        J_SERIALIZE_ITEM( v2 )
+    J_SERIALIZE_END
+};
+
+struct DA
+{
+    qint32  p1 = {1};
+    Asub2   p2;
+    QString p3 = {"5678"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+        J_SERIALIZE_ITEM( p3 )
+    J_SERIALIZE_END
+};
+
+struct DAopt
+{
+    qint32  p1 = {1};
+    Asub2   p2;
+    QString p3 = {"5678"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_OPT ( p2 )
+        J_SERIALIZE_ITEM( p3 )
+    J_SERIALIZE_END
+};
+
+struct Aopt
+{
+    qint32   p1 = {5};
+    QString  p2 = {"string1"};
+    qint64   p3 = {10};
+    QString  p4 = {"string2"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_OPT ( p2 )
+        J_SERIALIZE_ITEM( p3 )
+        J_SERIALIZE_OPT ( p4 )
+    J_SERIALIZE_END
+};
+
+struct Bptr : clife_base
+{
+    typedef clife_ptr<Bptr> Ptr;
+
+    qint32  v1 = {0};
+    QString v2 = {"str 1234"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( v1 )
+        J_SERIALIZE_OPT ( v2 )
+    J_SERIALIZE_END
+};
+
+struct Cptr
+{
+    typedef container_ptr<Cptr> Ptr;
+
+    qint64  v1 = {0};
+    QString v2 = {"str 5678"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( v1 )
+        J_SERIALIZE_OPT ( v2 )
+    J_SERIALIZE_END
+};
+
+struct B : clife_base
+{
+    typedef clife_ptr<B> Ptr;
+
+    qint32  p1 = {0};
+    QString p2 = {"b"};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_OPT ( p2 )
+    J_SERIALIZE_END
+};
+
+struct D
+{
+    qint32    p1 = {0};
+    QString   p2 = {"5678"};
+    Bptr::Ptr p3;
+    Cptr::Ptr p4;
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+        J_SERIALIZE_OPT ( p3 )
+        J_SERIALIZE_OPT ( p4 )
+    J_SERIALIZE_END
+};
+
+struct F
+{
+    float  p1 = {0};
+    double p2 = {0};
+
+    J_SERIALIZE_BEGIN
+        J_SERIALIZE_ITEM( p1 )
+        J_SERIALIZE_ITEM( p2 )
+    J_SERIALIZE_END
+};
+
+template<typename ListT>
+struct L
+{
+    ListT list;
+    J_SERIALIZE_ONE( list )
+};
+
+template<typename MapT>
+struct M
+{
+    MapT map;
+    J_SERIALIZE_ONE( map )
+};
+
+} // namespace data
+} // namespace pproto
+
+// Each shape is checked for:
+//   - everything allocated by toJson()/fromJson() is released;
+//   - repeated calls on the same data allocate the same number of times;
+//   - the number of allocations stays within the budget: the fixed cost of
+//     one call plus the per-item cost of the shape times the number of items.
+// The budgets are ceilings, not measured values. The fixed cost covers the
+// buffers and stacks of rapidjson, the parsed document and the resulting
+// QByteArray. The per-item cost is about twice the number of heap-owning
+// members of the item (list or map node, QString, QByteArray, object behind
+// a smart-pointer); a raw JSON QByteArray member counts as several, it goes
+// through a rapidjson writer of its own. An item that starts to allocate
+// a few times more than its members need breaks the budget.
+// Counters are per thread: a block allocated here and released by another
+// thread (a log record handled by the logger thread) shows as live, so
+// the checked calls must not log on success
+
+const size_t toJsonFixed   = {16};
+const size_t fromJsonFixed = {24};
+
+template<typename T>
+size_t toJsonAllocs(T& obj)
+{
+    (void) obj.toJson(); // warm-up, lazy static data of Qt
+
+    alloc::Scope scope;
+    {
+        QByteArray json = obj.toJson();
+    }
+    size_t allocs = scope.allocs();
+    ptrdiff_t live = scope.liveBlocks();
+
+    REQUIRE( live == 0 );
+
+    scope.reset();
+    {
+        QByteArray json = obj.toJson();
+    }
+    REQUIRE( scope.allocs() == allocs );
+    REQUIRE( scope.liveBlocks() == 0  );
+
+    return allocs;
+}
+
+template<typename T>
+size_t fromJsonAllocs(const QByteArray& json)
+{
+    { // warm-up
+        T obj;
+        pproto::SResult sr = obj.fromJson(json);
+        ALOG_FLUSH();
+        REQUIRE( bool(sr) == true );
+    }
+
+    bool result = false;
+    alloc::Scope scope;
+    {
+        T obj;
+        result = bool(obj.fromJson(json));
+    }
+    size_t allocs = scope.allocs();
+    ptrdiff_t live = scope.liveBlocks();
+
+    REQUIRE( result == true );
+    REQUIRE( live == 0 );
+
+    scope.reset();
+    {
+        T obj;
+        result = bool(obj.fromJson(json));
+    }
+    REQUIRE( result == true );
+    REQUIRE( scope.allocs() == allocs );
+    REQUIRE( scope.liveBlocks() == 0  );
+
+    return allocs;
+}
+
+// The budget of 100 items and the slope from 100 to 1000 items
+template<typename T, typename FillFunc>
+void requireLinearAllocs(size_t toJsonItem, size_t fromJsonItem, FillFunc fill)
+{
+    T obj100;
+    fill(obj100, 100);
+
+    T obj1000;
+    fill(obj1000, 1000);
+
+    size_t to100  = toJsonAllocs(obj100);
+    size_t to1000 = toJsonAllocs(obj1000);
+    INFO( "toJson allocs, 100 items: " << to100 << ", 1000 items: " << to1000 );
+    REQUIRE( to100  <= toJsonFixed + 100 * toJsonItem );
+    REQUIRE( to1000 <= to100 + 900 * toJsonItem );
+
+    size_t from100  = fromJsonAllocs<T>(obj100.toJson());
+    size_t from1000 = fromJsonAllocs<T>(obj1000.toJson());
+    INFO( "fromJson allocs, 100 items: " << from100 << ", 1000 items: " << from1000 );
+    REQUIRE( from100  <= fromJsonFixed + 100 * fromJsonItem );
+    REQUIRE( from1000 <= from100 + 900 * fromJsonItem );
+}
+
+TEST_CASE( "Allocations of flat structure", "[json][alloc]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Single structure" )
+    {
+        A a;
+        a.p1 = 10;
+        a.p2 = "string";
+        a.p3 = "bytearray long string 12345678900";
+
+        REQUIRE( toJsonAllocs(a)               <= toJsonFixed   + 6  );
+        REQUIRE( fromJsonAllocs<A>(a.toJson()) <= fromJsonFixed + 10 );
+    }
+    SECTION( "List of structures" )
+    {
+        requireLinearAllocs<L<QList<A>>>(6, 10, [](L<QList<A>>& l, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                l.list.append({i, QString("string %1").arg(i), QByteArray::number(i)});
+        });
+    }
+}
+
+TEST_CASE( "Allocations of nested structure", "[json][alloc]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "List of scalar structures" )
+    {
+        requireLinearAllocs<A3>(1, 2, [](A3& a, int count)
+        {
+            a.p1 = 10;
+            a.p2 = "string";
+            for (int i = 0; i < count; ++i)
+                a.p3.append({i, i * 0.5});
+        });
+    }
+    SECTION( "Nested structure" )
+    {
+        DA da;
+        REQUIRE( toJsonAllocs(da)                <= toJsonFixed   + 4 );
+        REQUIRE( fromJsonAllocs<DA>(da.toJson()) <= fromJsonFixed + 5 );
+    }
+    SECTION( "List of nested structures" )
+    {
+        requireLinearAllocs<L<QList<DA>>>(4, 5, [](L<QList<DA>>& l, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                DA da;
+                da.p1 = i;
+                da.p2.v1 = -i;
+                da.p2.v2 = QString("da%1").arg(i);
+                l.list.append(da);
+            }
+        });
+    }
+    SECTION( "Nested optional structure is missing" )
+    {
+        REQUIRE( fromJsonAllocs<DAopt>(R"({"p1":10,"p3":"string"})") <= fromJsonFixed + 5 );
+    }
+    SECTION( "List of nested optional structures" )
+    {
+        // Every second item misses the nested structure
+        QByteArray json = R"({"list":[)";
+        for (int i = 0; i < 1000; ++i)
+        {
+            if (i != 0)
+                json += ',';
+
+            json += R"({"p1":)" + QByteArray::number(i);
+            if (i % 2 == 0)
+                json += R"(,"p2":{"v1":)" + QByteArray::number(i) + R"(,"v2":"str"})";
+            json += R"(,"p3":"string"})";
+        }
+        json += "]}";
+
+        REQUIRE( fromJsonAllocs<L<QList<DAopt>>>(json) <= fromJsonFixed + 1000 * 5 );
+    }
+}
+
+TEST_CASE( "Allocations of bytearray field with JSON subtree", "[json][alloc]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Single structure" )
+    {
+        A a;
+        a.p1 = 10;
+        a.p2 = "string";
+        a.p3 = R"({"v1":37,"v2":0.987})";
+
+        REQUIRE( toJsonAllocs(a)               <= toJsonFixed   + 8  );
+        REQUIRE( fromJsonAllocs<A>(a.toJson()) <= fromJsonFixed + 10 );
+    }
+    SECTION( "List of structures" )
+    {
+        requireLinearAllocs<L<QList<A>>>(8, 10, [](L<QList<A>>& l, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                QByteArray sub = R"({"v1":)" + QByteArray::number(i)
+                               + R"(,"v2":[1,2,{"v3":"s"}]})";
+                l.list.append({i, QString("string %1").arg(i), sub});
+            }
+        });
+    }
+}
+
+TEST_CASE( "Allocations of structure with optional fields", "[json][alloc]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Filling out mandatory fields" )
+    {
+        REQUIRE( fromJsonAllocs<Aopt>(R"({"p1":10,"p3":20})") <= fromJsonFixed + 5 );
+    }
+    SECTION( "Filling out optional fields as NULL" )
+    {
+        REQUIRE( fromJsonAllocs<Aopt>(R"({"p1":10,"p2":null,"p3":20,"p4":null})") <= fromJsonFixed + 5 );
+    }
+    SECTION( "List of structures" )
+    {
+        requireLinearAllocs<L<QList<Aopt>>>(4, 5, [](L<QList<Aopt>>& l, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                l.list.append({i, QString("string %1").arg(i), i * 10, "string"});
+        });
+    }
+}
+
+TEST_CASE( "Allocations of smart-pointer fields", "[json][alloc]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Empty smart-pointers" )
+    {
+        D d;
+        REQUIRE( toJsonAllocs(d) <= toJsonFixed + 5 );
+        REQUIRE( fromJsonAllocs<D>(R"({"p1":14,"p2":"string 890","p3":null,"p4":null})") <= fromJsonFixed + 5 );
+    }
+    SECTION( "List of structures" )
+    {
+        requireLinearAllocs<L<QList<D>>>(5, 10, [](L<QList<D>>& l, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                D d;
+                d.p1 = i;
+                d.p3 = Bptr::Ptr{new Bptr};
+                d.p3->v1 = i;
+                d.p4 = Cptr::Ptr{new Cptr};
+                d.p4->v1 = -i;
+                l.list.append(d);
+            }
+        });
+    }
+}
+
+TEST_CASE( "Allocations of real number fields", "[json][alloc]" )
+{
+    using namespace pproto::data;
+
+    F f;
+    f.p1 = 1.5;
+    f.p2 = 2.25;
+
+    REQUIRE( toJsonAllocs(f)                                 <= toJsonFixed   );
+    REQUIRE( fromJsonAllocs<F>(R"({"p1":1.5,"p2":2.25})")   <= fromJsonFixed );
+    REQUIRE( fromJsonAllocs<F>(R"({"p1":null,"p2":null})") <= fromJsonFixed );
+}
+
+TEST_CASE( "Allocations of Map-s", "[json][alloc]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "QMap<int, A>" )
+    {
+        requireLinearAllocs<M<QMap<int, A>>>(6, 10, [](M<QMap<int, A>>& m, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                m.map[i] = A{i, QString("mp%1").arg(i), QByteArray::number(i)};
+        });
+    }
+    SECTION( "std::map<int, A>" )
+    {
+        requireLinearAllocs<M<std::map<int, A>>>(6, 10, [](M<std::map<int, A>>& m, int count)
+        {
+            for (int i = 0; i < count; ++i)
+                m.map[i] = A{i, QString("mp%1").arg(i), QByteArray::number(i)};
+        });
+    }
+}
+
+TEST_CASE( "Allocations of lst::List", "[json][alloc]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "lst::List<A>" )
+    {
+        requireLinearAllocs<L<lst::List<A>>>(6, 10, [](L<lst::List<A>>& l, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                A* a = l.list.add();
+                a->p1 = i;
+                a->p2 = QString("a%1").arg(i);
+                a->p3 = QByteArray::number(i);
+            }
+        });
+    }
+    SECTION( "lst::List<B, clife_alloc<B>>" )
+    {
+        using BList = L<lst::List<B, clife_alloc<B>>>;
+        requireLinearAllocs<BList>(3, 4, [](BList& l, int count)
+        {
+            for (int i = 0; i < count; ++i)
+            {
+                B* b = l.list.add();
+                b->p1 = i;
+                b->p2 = QString("b%1").arg(i);
+            }
+        });
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    int result = Catch::Session().run(argc, argv);
+
+    alog::stop();
+
+    return result;
+}
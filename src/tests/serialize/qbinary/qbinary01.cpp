@@ -0,0 +1,288 @@
+#include "shared/logger/logger.h"
+#include "shared/logger/format.h"
+#include "pproto/serialize/qbinary.h"
+
+#include "catch2/log_saver.h"
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_session.hpp"
+
+#include <QDataStream>
+
+namespace pproto {
+namespace data {
+
+struct S
+{
+    qint32 p1 = {0};
+    qint64 p2 = {0};
+    double p3 = {0};
+    float  p4 = {0};
+
+    DECLARE_B_SERIALIZE_FUNC
+};
+
+struct SList
+{
+    QList<qint32>   p1;
+    QVector<double> p2;
+
+    DECLARE_B_SERIALIZE_FUNC
+};
+
+// Version 1 of the structure
+struct V1
+{
+    qint32 p1 = {0};
+
+    DECLARE_B_SERIALIZE_FUNC
+};
+
+// Version 2 of the structure, p2 is added in the second segment
+struct V2
+{
+    qint32 p1 = {0};
+    double p2 = {-1};
+
+    DECLARE_B_SERIALIZE_FUNC
+};
+
+bserial::RawVector S::toRaw() const
+{
+    B_SERIALIZE_V1(stream)
+    stream << p1;
+    stream << p2;
+    stream << p3;
+    stream << p4;
+    B_SERIALIZE_RETURN
+}
+
+void S::fromRaw(const bserial::RawVector& vect)
+{
+    B_DESERIALIZE_V1(vect, stream)
+    stream >> p1;
+    stream >> p2;
+    stream >> p3;
+    stream >> p4;
+    B_DESERIALIZE_END
+}
+
+bserial::RawVector SList::toRaw() const
+{
+    B_SERIALIZE_V1(stream)
+    stream << p1;
+    stream << p2;
+    B_SERIALIZE_RETURN
+}
+
+void SList::fromRaw(const bserial::RawVector& vect)
+{
+    B_DESERIALIZE_V1(vect, stream)
+    stream >> p1;
+    stream >> p2;
+    B_DESERIALIZE_END
+}
+
+bserial::RawVector V1::toRaw() const
+{
+    B_SERIALIZE_V1(stream)
+    stream << p1;
+    B_SERIALIZE_RETURN
+}
+
+void V1::fromRaw(const bserial::RawVector& vect)
+{
+    B_DESERIALIZE_V1(vect, stream)
+    stream >> p1;
+    B_DESERIALIZE_END
+}
+
+bserial::RawVector V2::toRaw() const
+{
+    B_SERIALIZE_V1(stream)
+    stream << p1;
+    B_SERIALIZE_V2(stream)
+    stream << p2;
+    B_SERIALIZE_RETURN
+}
+
+void V2::fromRaw(const bserial::RawVector& vect)
+{
+    B_DESERIALIZE_V1(vect, stream)
+    stream >> p1;
+    B_DESERIALIZE_V2(vect, stream)
+    stream >> p2;
+    B_DESERIALIZE_END
+}
+
+} // namespace data
+} // namespace pproto
+
+// The payload of a segment is pinned byte for byte: big-endian integers,
+// IEEE-754 doubles, float written as double (QDataStream::DoublePrecision),
+// lists as quint32 count followed by the items. The framing of segments
+// is checked by position of the payloads and by round trip
+
+template<typename T>
+QByteArray serialize(const T& obj)
+{
+    QByteArray ba;
+    QDataStream stream {&ba, QIODevice::WriteOnly};
+    stream.setVersion(QDATASTREAM_VERSION);
+    stream << obj.toRaw();
+    return ba;
+}
+
+template<typename T>
+T deserialize(const QByteArray& ba)
+{
+    pproto::bserial::RawVector vect;
+    QDataStream stream {ba};
+    stream.setVersion(QDATASTREAM_VERSION);
+    stream >> vect;
+
+    T obj;
+    obj.fromRaw(vect);
+    return obj;
+}
+
+TEST_CASE( "QBinary wire format of scalar fields", "[qbinary]" )
+{
+    using namespace pproto::data;
+
+    S s;
+    s.p1 = -2;
+    s.p2 = 0x0102030405060708ll;
+    s.p3 = 1.5;
+    s.p4 = -0.25f;
+
+    const QByteArray payload = QByteArray::fromHex(
+        "fffffffe"            // p1
+        "0102030405060708"    // p2
+        "3ff8000000000000"    // p3
+        "bfd0000000000000");  // p4
+
+    QByteArray ba = serialize(s);
+    REQUIRE( ba.endsWith(payload) );
+    REQUIRE( ba.indexOf(payload) == ba.size() - payload.size() );
+
+    S ss = deserialize<S>(ba);
+    REQUIRE( ss.p1 == -2                   );
+    REQUIRE( ss.p2 == 0x0102030405060708ll );
+    REQUIRE( ss.p3 == 1.5                  );
+    REQUIRE( ss.p4 == -0.25f               );
+}
+
+TEST_CASE( "QBinary wire format of list fields", "[qbinary]" )
+{
+    using namespace pproto::data;
+
+    SECTION( "Non-empty lists" )
+    {
+        SList sl;
+        sl.p1 = {1, -1, 0x7fffffff};
+        sl.p2 = {0.5, 2.0};
+
+        const QByteArray payload = QByteArray::fromHex(
+            "00000003" "00000001" "ffffffff" "7fffffff"           // p1
+            "00000002" "3fe0000000000000" "4000000000000000");    // p2
+
+        QByteArray ba = serialize(sl);
+        REQUIRE( ba.endsWith(payload) );
+
+        SList ssl = deserialize<SList>(ba);
+        REQUIRE( ssl.p1 == sl.p1 );
+        REQUIRE( ssl.p2 == sl.p2 );
+    }
+    SECTION( "Empty lists" )
+    {
+        SList sl;
+
+        const QByteArray payload = QByteArray::fromHex("00000000" "00000000");
+
+        QByteArray ba = serialize(sl);
+        REQUIRE( ba.endsWith(payload) );
+
+        SList ssl = deserialize<SList>(ba);
+        REQUIRE( ssl.p1.isEmpty() );
+        REQUIRE( ssl.p2.isEmpty() );
+    }
+    SECTION( "Long lists" )
+    {
+        // Long enough for the bulk copy of an encoder to take over
+        SList sl;
+        QByteArray payload = QByteArray::fromHex("000003e8");
+        for (int i = 0; i < 1000; ++i)
+        {
+            sl.p1.append(i * 65537);
+            char item[4] = {char((i * 65537) >> 24), char((i * 65537) >> 16),
+                            char((i * 65537) >> 8),  char(i * 65537)};
+            payload.append(item, 4);
+        }
+        payload.append(QByteArray::fromHex("00000000"));
+
+        QByteArray ba = serialize(sl);
+        REQUIRE( ba.endsWith(payload) );
+
+        SList ssl = deserialize<SList>(ba);
+        REQUIRE( ssl.p1 == sl.p1 );
+    }
+}
+
+TEST_CASE( "QBinary versioned segments", "[qbinary]" )
+{
+    using namespace pproto::data;
+
+    const QByteArray payload1 = QByteArray::fromHex("0000000a");         // p1
+    const QByteArray payload2 = QByteArray::fromHex("4004000000000000"); // p2
+
+    SECTION( "Segments follow in version order" )
+    {
+        V2 v2;
+        v2.p1 = 10;
+        v2.p2 = 2.5;
+
+        QByteArray ba = serialize(v2);
+        REQUIRE( ba.endsWith(payload2) );
+        REQUIRE( ba.indexOf(payload1) >= 0 );
+        REQUIRE( ba.indexOf(payload1) < ba.indexOf(payload2) );
+
+        V2 vv2 = deserialize<V2>(ba);
+        REQUIRE( vv2.p1 == 10  );
+        REQUIRE( vv2.p2 == 2.5 );
+    }
+    SECTION( "Old reader skips newer segment" )
+    {
+        V2 v2;
+        v2.p1 = 10;
+        v2.p2 = 2.5;
+
+        V1 v1 = deserialize<V1>(serialize(v2));
+        REQUIRE( v1.p1 == 10 );
+    }
+    SECTION( "New reader of old data" )
+    {
+        V1 v1;
+        v1.p1 = 10;
+
+        QByteArray ba = serialize(v1);
+        REQUIRE( ba.endsWith(payload1) );
+
+        V2 v2 = deserialize<V2>(ba);
+        REQUIRE( v2.p1 == 10 );
+        REQUIRE( v2.p2 == -1 ); // default value
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    alog::logger().start();
+
+    alog::Saver::Ptr saver {new alog::CatchSaver()};
+    alog::logger().addSaver(saver);
+
+    int result = Catch::Session().run(argc, argv);
+
+    alog::stop();
+
+    return result;
+}